@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <gmpxx.h>
 #include <iostream>
 #include <map>
 #include <sstream>
@@ -7,6 +6,9 @@
 #include <vector>
 #include <stdlib.h>
 
+#include "counters.h"
+#include "rng.h"
+
 using namespace std;
 
 class Food
@@ -116,6 +118,7 @@ void testGreedys(const vector<Food> &foods, double maxUnits)
 double maxVal(const vector<Food> &toConsider, double avail, vector<Food> *toTake)
 {
     double totalValue;
+    COUNT(recursiveCalls);
 
     if (toConsider.empty() || avail == 0) {
         totalValue = 0;
@@ -165,15 +168,14 @@ void testMaxVal(const vector<Food> &foods, double maxUnits, bool printItems = tr
     }
 }
 
-gmp_randclass rng(gmp_randinit_default);
+Rng rng;
 int randint(int min, int max)
 {
     // http://c-faq.com/lib/randrange.html
     // return min + rand() / (RAND_MAX / (max - min + 1) + 1);
 
     // rng.seed(time(NULL)); // called once, in main
-    mpz_class n = rng.get_z_range(mpz_class(max - min + 1)) + min;
-    return n.get_si();
+    return rng.randint(min, max);
 }
 
 // http://www.cplusplus.com/articles/D9j2Nwbp/
@@ -210,6 +212,7 @@ double fastMaxVal(const vector<Food> &toConsider, double avail, vector<Food> *to
 {
     double totalValue;
     Key k = {toConsider, avail};
+    COUNT(recursiveCalls);
 
     if (toConsider.empty() || avail == 0) {
         totalValue = 0;
@@ -217,9 +220,11 @@ double fastMaxVal(const vector<Food> &toConsider, double avail, vector<Food> *to
     } else {
         try {
             Result r = memo.at(k);
+            COUNT(memoHits);
             totalValue = r.totalValue;
             *toTake = r.taken;
         } catch(out_of_range&) {
+            COUNT(memoMisses);
             if (toConsider.at(0).getCost() > avail) {
                 // explore right branch only
                 vector<Food> nextToConsider(toConsider.begin() + 1, toConsider.end());
@@ -299,6 +304,8 @@ int main()
         // testMaxVal(items, 750, true);
         testFastMaxVal(items, 750, true);
     }
+
+    return 0;
 }
 
 
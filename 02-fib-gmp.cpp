@@ -2,6 +2,8 @@
 #include <iostream>
 #include <map>
 
+#include "counters.h"
+
 using namespace std;
 
 int fib(mpz_class n)
@@ -15,12 +17,16 @@ int fib(mpz_class n)
 
 mpz_class fastFib(mpz_class n, map<mpz_class, mpz_class> &memo)
 {
+    COUNT(recursiveCalls);
     if (n == 0 || n == 1)
         return 1;
 
     try {
-        return memo.at(n);
+        mpz_class result = memo.at(n);
+        COUNT(memoHits);
+        return result;
     } catch(out_of_range&) {
+        COUNT(memoMisses);
         mpz_class result = fastFib(n - 1, memo) + fastFib(n - 2, memo);
         memo[n] = result;
         return result;
@@ -39,4 +45,6 @@ int main()
         // cout << "fib(" << i << ") = " << fib(i) << endl;
         cout << "fib(" << i << ") = " << fastFib(i).get_str() << endl;
     }
+
+    return 0;
 }
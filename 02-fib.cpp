@@ -1,6 +1,8 @@
 #include <iostream>
 #include <map>
 
+#include "counters.h"
+
 using namespace std;
 
 int fib(int n)
@@ -14,12 +16,16 @@ int fib(int n)
 
 int fastFib(int n, map<int, int> &memo)
 {
+    COUNT(recursiveCalls);
     if (n == 0 || n == 1)
         return 1;
 
     try {
-        return memo.at(n);
+        int result = memo.at(n);
+        COUNT(memoHits);
+        return result;
     } catch(out_of_range&) {
+        COUNT(memoMisses);
         int result = fastFib(n - 1, memo) + fastFib(n - 2, memo);
         memo[n] = result;
         return result;
@@ -38,4 +44,6 @@ int main()
         // cout << "fib(" << i << ") = " << fib(i) << endl;
         cout << "fib(" << i << ") = " << fastFib(i) << endl;
     }
+
+    return 0;
 }
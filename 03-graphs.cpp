@@ -1,9 +1,12 @@
 #include <algorithm>
+#include <climits>
 #include <map>
 #include <iostream>
 #include <iterator>
 #include <vector>
 
+#include "counters.h"
+
 using namespace std;
 
 class Node
@@ -82,6 +85,11 @@ class DiGraph
     private:
         map<Node, vector<Node> > edges;
 
+        // nodes numbered in insertion order, so searches can use flat arrays
+        map<Node, int> ids;
+        vector<Node> nodes;
+        vector<vector<int> > adjacency;
+
     public:
         void addNode(Node node)
         {
@@ -89,6 +97,9 @@ class DiGraph
                 throw ValueError("Duplicate node");
             } else {
                 edges[node] = vector<Node>();
+                ids[node] = nodes.size();
+                nodes.push_back(node);
+                adjacency.push_back(vector<int>());
             }
         }
 
@@ -101,6 +112,7 @@ class DiGraph
                 throw ValueError("Node not in graph");
             } else {
                 edges[src].push_back(dest);
+                adjacency[ids[src]].push_back(ids[dest]);
             }
         }
 
@@ -109,6 +121,26 @@ class DiGraph
             return edges.at(node);
         }
 
+        const vector<int> &childrenOf(int index) const
+        {
+            return adjacency.at(index);
+        }
+
+        int size() const
+        {
+            return nodes.size();
+        }
+
+        int indexOf(Node &node) const
+        {
+            return ids.at(node);
+        }
+
+        Node &nodeAt(int index)
+        {
+            return nodes.at(index);
+        }
+
         bool hasNode(Node &node)
         {
             return edges.find(node) != edges.end();
@@ -196,32 +228,97 @@ ostream &operator<<(ostream &o, vector<Node> &n)
     return o;
 }
 
+void printPath(ostream &o, DiGraph &graph, const vector<int> &path, unsigned int size)
+{
+    for (unsigned int i = 0; i < size; i++) {
+        if (i > 0) {
+            o << "->";
+        }
+        o << graph.nodeAt(path[i]).getName();
+    }
+}
+
 // Depth First Search
-vector<Node> DFS(DiGraph &graph, Node start, Node end, vector<Node> path, vector<Node> shortest, bool toPrint = false)
+//
+// Iterative: the current path lives in preallocated arrays (one frame per
+// node on the path), so the depth is bounded by the number of nodes and not
+// by the call stack.  A node is not expanded again at a depth greater than or
+// equal to one it was already expanded at, since no shorter path can come
+// out of it.
+vector<Node> DFS(DiGraph &graph, Node start, Node end, bool toPrint = false)
 {
-    path.push_back(start);
+    int n = graph.size();
+    int target = graph.indexOf(end);
+
+    vector<int> path(n);
+    vector<unsigned int> nextChild(n, 0);
+    vector<bool> onPath(n, false);
+    vector<int> depth(n, INT_MAX);
+    vector<int> shortest;
+
+    unsigned int size = 1;
+    path[0] = graph.indexOf(start);
+    onPath[path[0]] = true;
+    depth[path[0]] = 0;
     if (toPrint) {
-        cout << "Current DFS path: " << path << endl;
-    }
-    if (start == end) {
-        return path;
+        cout << "Current DFS path: ";
+        printPath(cout, graph, path, size);
+        cout << endl;
     }
-    vector<Node> children = graph.childrenOf(start);
-    typedef vector<Node>::const_iterator CI;
-    for (CI it = children.begin(); it != children.end(); it++) {
-        Node node = *it;
-        if (find(path.begin(), path.end(), node) == path.end()) { // avoid cycles
-            if (shortest.empty() || path.size() < shortest.size()) {
-                vector<Node> newPath = DFS(graph, node, end, path, shortest, toPrint);
-                if (!newPath.empty()) {
-                    shortest = newPath;
+
+    if (path[0] != target) {
+        while (size > 0) {
+            int node = path[size - 1];
+            const vector<int> &children = graph.childrenOf(node);
+
+            if (nextChild[size - 1] == children.size()) {
+                onPath[node] = false;
+                size--;
+                continue;
+            }
+
+            int child = children[nextChild[size - 1]++];
+            if (onPath[child]) { // avoid cycles
+                if (toPrint) {
+                    cout << "Already visited " << graph.nodeAt(child) << endl;
                 }
+                continue;
+            }
+            if (!shortest.empty() && size >= shortest.size()) {
+                continue;
+            }
+            if (depth[child] <= (int) size) {
+                continue;
+            }
+
+            depth[child] = size;
+            path[size] = child;
+            nextChild[size] = 0;
+            COUNT(recursiveCalls);
+            onPath[child] = true;
+            size++;
+            if (toPrint) {
+                cout << "Current DFS path: ";
+                printPath(cout, graph, path, size);
+                cout << endl;
+            }
+
+            if (child == target) {
+                shortest.assign(path.begin(), path.begin() + size);
+                onPath[child] = false;
+                size--;
             }
-        } else if (toPrint) {
-            cout << "Already visited " << node << endl;
         }
+    } else {
+        shortest.push_back(path[0]);
     }
-    return shortest;
+
+    vector<Node> result;
+    result.reserve(shortest.size());
+    for (unsigned int i = 0; i < shortest.size(); i++) {
+        result.push_back(graph.nodeAt(shortest[i]));
+    }
+    return result;
 }
 
 bool printQueue = false;
@@ -234,6 +331,7 @@ vector<Node> BFS(DiGraph &graph, Node start, Node end, bool toPrint = false)
 
     initPath.push_back(start);
     pathQueue.push_back(initPath);
+    COUNT(queuePushes);
 
     while(pathQueue.size() != 0) {
         // Get and remove oldest element in pathQueue
@@ -261,6 +359,7 @@ vector<Node> BFS(DiGraph &graph, Node start, Node end, bool toPrint = false)
                 vector<Node> newPath = tmpPath;
                 newPath.push_back(nextNode);
                 pathQueue.push_back(newPath);
+                COUNT(queuePushes);
             }
         }
     }
@@ -268,10 +367,320 @@ vector<Node> BFS(DiGraph &graph, Node start, Node end, bool toPrint = false)
     return vector<Node>();
 }
 
+// Strongly connected components of a DiGraph, condensed into a DAG.
+//
+// Each component gets numLabels labels (rank, low): rank is the position of
+// the component in a post-order of the DAG, so every DAG edge goes from a
+// higher rank to a lower one, and low is the lowest rank it can reach.  If u
+// reaches v then rank[v] <= rank[u] and low[u] <= low[v] in every label, so a
+// pair failing any of these tests has no path and is rejected in O(1).  The
+// first post-order is the one Tarjan's algorithm finishes components in; the
+// others walk the DAG in the opposite order, which separates unrelated parts
+// of the graph that the first one interleaves (as in GRAIL, Yildirim et al.).
+//
+// This is a filter: a pair that passes every test is answered by a search on
+// the DAG, pruned by the same tests.
+class ReachabilityIndex
+{
+    private:
+        static const int numLabels = 2;
+
+        DiGraph &graph;
+        bool stale;
+
+        vector<int> component;
+        vector<vector<int> > dag;
+        vector<vector<int> > reverseDag;
+        vector<long> rank[numLabels];
+        vector<long> low[numLabels];
+
+        // nodes added after a build rank below everything else, so edges
+        // from the existing graph to them keep every label valid
+        long nextNewRank;
+
+        // scratch space for search() and refresh(), reused between calls
+        vector<unsigned int> seen;
+        unsigned int query;
+        vector<int> toVisit;
+
+        void build()
+        {
+            int n = graph.size();
+            vector<int> index(n, -1);
+            vector<int> lowLink(n);
+            vector<bool> onStack(n, false);
+            vector<int> stack;
+            vector<int> frameNode;
+            vector<unsigned int> frameChild;
+            int counter = 0;
+
+            component.assign(n, -1);
+            dag.clear();
+
+            for (int s = 0; s < n; s++) {
+                if (index[s] != -1) {
+                    continue;
+                }
+                index[s] = lowLink[s] = counter++;
+                stack.push_back(s);
+                onStack[s] = true;
+                frameNode.push_back(s);
+                frameChild.push_back(0);
+
+                while (!frameNode.empty()) {
+                    int v = frameNode.back();
+                    const vector<int> &children = graph.childrenOf(v);
+
+                    if (frameChild.back() < children.size()) {
+                        int w = children[frameChild.back()++];
+                        if (index[w] == -1) {
+                            index[w] = lowLink[w] = counter++;
+                            stack.push_back(w);
+                            onStack[w] = true;
+                            frameNode.push_back(w);
+                            frameChild.push_back(0);
+                        } else if (onStack[w]) {
+                            lowLink[v] = min(lowLink[v], index[w]);
+                        }
+                        continue;
+                    }
+
+                    frameNode.pop_back();
+                    frameChild.pop_back();
+                    if (!frameNode.empty()) {
+                        int u = frameNode.back();
+                        lowLink[u] = min(lowLink[u], lowLink[v]);
+                    }
+                    if (lowLink[v] == index[v]) {
+                        int c = dag.size();
+                        int w;
+                        do {
+                            w = stack.back();
+                            stack.pop_back();
+                            onStack[w] = false;
+                            component[w] = c;
+                        } while (w != v);
+                        dag.push_back(vector<int>());
+                    }
+                }
+            }
+
+            int numComponents = dag.size();
+            reverseDag.assign(numComponents, vector<int>());
+            for (int u = 0; u < n; u++) {
+                const vector<int> &children = graph.childrenOf(u);
+                for (unsigned int i = 0; i < children.size(); i++) {
+                    int cu = component[u];
+                    int cv = component[children[i]];
+                    if (cu != cv) {
+                        dag[cu].push_back(cv);
+                        reverseDag[cv].push_back(cu);
+                    }
+                }
+            }
+
+            // Tarjan finishes components in post-order
+            vector<int> postOrder(numComponents);
+            for (int c = 0; c < numComponents; c++) {
+                postOrder[c] = c;
+            }
+            setLabel(0, postOrder);
+
+            // the same walk from the other end: roots from the highest
+            // number down, children last to first
+            for (int l = 1; l < numLabels; l++) {
+                vector<bool> visited(numComponents, false);
+                postOrder.clear();
+                for (int s = numComponents - 1; s >= 0; s--) {
+                    if (visited[s]) {
+                        continue;
+                    }
+                    visited[s] = true;
+                    frameNode.push_back(s);
+                    frameChild.push_back(dag[s].size());
+
+                    while (!frameNode.empty()) {
+                        int c = frameNode.back();
+                        if (frameChild.back() > 0) {
+                            int next = dag[c][--frameChild.back()];
+                            if (!visited[next]) {
+                                visited[next] = true;
+                                frameNode.push_back(next);
+                                frameChild.push_back(dag[next].size());
+                            }
+                            continue;
+                        }
+                        frameNode.pop_back();
+                        frameChild.pop_back();
+                        postOrder.push_back(c);
+                    }
+                }
+                setLabel(l, postOrder);
+            }
+
+            nextNewRank = -1;
+            seen.assign(numComponents, 0);
+            query = 0;
+            stale = false;
+        }
+
+        // Ranks components by their position in postOrder and computes the
+        // lowest rank each one reaches; successors come first in postOrder.
+        void setLabel(int l, const vector<int> &postOrder)
+        {
+            rank[l].resize(postOrder.size());
+            low[l].resize(postOrder.size());
+            for (unsigned int i = 0; i < postOrder.size(); i++) {
+                int c = postOrder[i];
+                rank[l][c] = low[l][c] = i;
+                for (unsigned int j = 0; j < dag[c].size(); j++) {
+                    low[l][c] = min(low[l][c], low[l][dag[c][j]]);
+                }
+            }
+        }
+
+        // nodes added to the graph since the last build are components of their own
+        void addNewNodes()
+        {
+            for (int u = component.size(); u < graph.size(); u++) {
+                int c = dag.size();
+                component.push_back(c);
+                dag.push_back(vector<int>());
+                reverseDag.push_back(vector<int>());
+                for (int l = 0; l < numLabels; l++) {
+                    rank[l].push_back(nextNewRank);
+                    low[l].push_back(nextNewRank);
+                }
+                nextNewRank--;
+                seen.push_back(0);
+            }
+        }
+
+        // lowers low of pred to that of its successor c; true if any changed
+        bool lowerFrom(int c, int pred)
+        {
+            bool lowered = false;
+            for (int l = 0; l < numLabels; l++) {
+                if (low[l][c] < low[l][pred]) {
+                    low[l][pred] = low[l][c];
+                    lowered = true;
+                }
+            }
+            return lowered;
+        }
+
+        bool mayReach(int from, int to) const
+        {
+            for (int l = 0; l < numLabels; l++) {
+                if (rank[l][to] > rank[l][from] || low[l][from] > low[l][to]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool search(int from, int to)
+        {
+            if (++query == 0) {
+                seen.assign(seen.size(), 0);
+                query = 1;
+            }
+            toVisit.clear();
+            toVisit.push_back(from);
+            seen[from] = query;
+
+            while (!toVisit.empty()) {
+                int c = toVisit.back();
+                toVisit.pop_back();
+                if (c == to) {
+                    return true;
+                }
+                for (unsigned int i = 0; i < dag[c].size(); i++) {
+                    int next = dag[c][i];
+                    if (seen[next] != query && mayReach(next, to)) {
+                        seen[next] = query;
+                        toVisit.push_back(next);
+                    }
+                }
+            }
+            return false;
+        }
+
+    public:
+        ReachabilityIndex(DiGraph &graph): graph(graph), stale(true), nextNewRank(-1), query(0) {}
+
+        bool canReach(Node src, Node dest)
+        {
+            if (stale) {
+                build();
+            } else {
+                addNewNodes();
+            }
+
+            int from = component[graph.indexOf(src)];
+            int to = component[graph.indexOf(dest)];
+
+            if (from == to) {
+                return true;
+            }
+            if (!mayReach(from, to)) {
+                return false;
+            }
+            return search(from, to);
+        }
+
+        // Updates the index for an edge already added to the graph.  An edge
+        // that goes down in every rank, such as one from the existing graph to
+        // a node added since, only lowers low on the way up from its source.
+        // One that closes a cycle or goes against a rank makes the next query
+        // rebuild the index.
+        void refresh(Edge edge)
+        {
+            if (stale) {
+                return;
+            }
+            addNewNodes();
+
+            Node src = edge.getSource();
+            Node dest = edge.getDestination();
+            int from = component[graph.indexOf(src)];
+            int to = component[graph.indexOf(dest)];
+
+            if (from == to) {
+                return;
+            }
+            for (int l = 0; l < numLabels; l++) {
+                if (rank[l][to] > rank[l][from]) {
+                    stale = true;
+                    return;
+                }
+            }
+
+            dag[from].push_back(to);
+            reverseDag[to].push_back(from);
+
+            toVisit.clear();
+            if (lowerFrom(to, from)) {
+                toVisit.push_back(from);
+            }
+            while (!toVisit.empty()) {
+                int c = toVisit.back();
+                toVisit.pop_back();
+                for (unsigned int i = 0; i < reverseDag[c].size(); i++) {
+                    int pred = reverseDag[c][i];
+                    if (lowerFrom(c, pred)) {
+                        toVisit.push_back(pred);
+                    }
+                }
+            }
+        }
+};
+
+const int ReachabilityIndex::numLabels;
+
 vector<Node> shortestPath(DiGraph &graph, Node start, Node end, bool toPrint = false)
 {
-    // vector<Node> path, shortest;
-    // return DFS(graph, start, end, path, shortest, toPrint);
+    // return DFS(graph, start, end, toPrint);
     return BFS(graph, start, end, toPrint);
 }
 
@@ -280,7 +689,12 @@ void testSP(string source, string destination)
     DiGraph g;
     buildCityGraph(&g);
 
-    vector<Node> sp = shortestPath(g, g.getNode(source), g.getNode(destination), true);
+    ReachabilityIndex reachable(g);
+    vector<Node> sp;
+
+    if (reachable.canReach(g.getNode(source), g.getNode(destination))) {
+        sp = shortestPath(g, g.getNode(source), g.getNode(destination), true);
+    }
 
     if (!sp.empty()) {
         cout << "Shortest path from " << source << " to " << destination << " is " << sp << endl;
@@ -293,4 +707,6 @@ int main()
 {
     // testSP("Chicago", "Boston");
     testSP("Boston", "Phoenix");
+
+    return 0;
 }
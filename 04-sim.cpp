@@ -2,23 +2,27 @@
 #include <gmpxx.h>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <math.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
+
+#include "rng.h"
 
 using namespace std;
 
-gmp_randclass rng(gmp_randinit_default);
+Rng rng;
 int randint(int min, int max) {
     // http://c-faq.com/lib/randrange.html
     // return min + rand() / (RAND_MAX / (max - min + 1) + 1);
 
     // rng.seed(time(NULL)); // called once, in main
-    mpz_class n = rng.get_z_range(mpz_class(max - min + 1)) + min;
-    return n.get_si();
+    return rng.randint(min, max);
 }
 
 // http://www.cplusplus.com/articles/D9j2Nwbp/
@@ -28,8 +32,12 @@ string to_string(int n) {
     return out.str();
 }
 
+int rollDie(Rng &r) {
+    return r.randint(1, 6);
+}
+
 int rollDie() {
-    return randint(1, 6);
+    return rollDie(rng);
 }
 
 void testRoll(int n = 10) {
@@ -42,18 +50,335 @@ void testRoll(int n = 10) {
     cout << result;
 }
 
-void runSim(string goal, int numTrials, string txt) {
-    double total = 0;
+// A Monte Carlo experiment: runs numTrials trials drawing only from r and
+// returns how many of them were hits.  Must be safe to call from several
+// threads at once.
+class Experiment {
+public:
+    virtual ~Experiment() {}
+    virtual long trials(Rng &r, long numTrials) const = 0;
+};
+
+int numThreads = 0; // 0: one per online processor
+
+// Threads that stay alive between jobs.  run() wakes them all on the same
+// task, works on it too, and returns once every thread is done with it.
+// Only one job at a time: run() must not be called from several threads.
+class WorkerPool {
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    vector<pthread_t> threads;
+
+    void *(*task)(void *);
+    void *arg;
+    unsigned long generation; // one more for each job handed out
+    int busy;
+    bool stopping;
+
+    static void *loop(void *self) {
+        WorkerPool *pool = (WorkerPool *) self;
+        unsigned long seen = 0;
+
+        pthread_mutex_lock(&pool->mutex);
+        for (;;) {
+            while (pool->generation == seen && !pool->stopping) {
+                pthread_cond_wait(&pool->wake, &pool->mutex);
+            }
+            if (pool->stopping) {
+                break;
+            }
+            seen = pool->generation;
+            void *(*task)(void *) = pool->task;
+            void *arg = pool->arg;
+
+            pthread_mutex_unlock(&pool->mutex);
+            task(arg);
+            pthread_mutex_lock(&pool->mutex);
+
+            if (--pool->busy == 0) {
+                pthread_cond_signal(&pool->done);
+            }
+        }
+        pthread_mutex_unlock(&pool->mutex);
+
+        return NULL;
+    }
+
+public:
+    // numWorkers counts the calling thread
+    WorkerPool(int numWorkers): task(NULL), arg(NULL), generation(0), busy(0), stopping(false) {
+        pthread_mutex_init(&mutex, NULL);
+        pthread_cond_init(&wake, NULL);
+        pthread_cond_init(&done, NULL);
+
+        for (int t = 0; t < numWorkers - 1; t++) {
+            pthread_t thread;
+            if (pthread_create(&thread, NULL, loop, this) != 0) {
+                break;
+            }
+            threads.push_back(thread);
+        }
+    }
+
+    ~WorkerPool() {
+        pthread_mutex_lock(&mutex);
+        stopping = true;
+        pthread_cond_broadcast(&wake);
+        pthread_mutex_unlock(&mutex);
+
+        for (unsigned int t = 0; t < threads.size(); t++) {
+            pthread_join(threads[t], NULL);
+        }
+        pthread_cond_destroy(&done);
+        pthread_cond_destroy(&wake);
+        pthread_mutex_destroy(&mutex);
+    }
+
+    int size() const {
+        return threads.size() + 1;
+    }
+
+    void run(void *(*task)(void *), void *arg) {
+        pthread_mutex_lock(&mutex);
+        this->task = task;
+        this->arg = arg;
+        busy = threads.size();
+        generation++;
+        pthread_cond_broadcast(&wake);
+        pthread_mutex_unlock(&mutex);
+
+        task(arg);
+
+        pthread_mutex_lock(&mutex);
+        while (busy > 0) {
+            pthread_cond_wait(&done, &mutex);
+        }
+        pthread_mutex_unlock(&mutex);
+    }
+};
+
+// The pool shared by all TrialRunners, started on first use and started
+// again if numThreads changes.
+WorkerPool &workerPool() {
+    static struct Holder {
+        WorkerPool *pool;
+        int numWorkers;
+        ~Holder() { delete pool; }
+    } holder = {NULL, 0};
+
+    int numWorkers = numThreads > 0 ? numThreads : sysconf(_SC_NPROCESSORS_ONLN);
+    numWorkers = max(1, numWorkers);
+    if (holder.pool == NULL || holder.numWorkers != numWorkers) {
+        delete holder.pool;
+        holder.pool = new WorkerPool(numWorkers);
+        holder.numWorkers = numWorkers;
+    }
+    return *holder.pool;
+}
+
+// Splits the trials into fixed-size chunks, each with its own stream jumped
+// ahead from the previous one.  The threads of workerPool() claim chunks from
+// a shared counter, and the hits are added up per chunk, so for the same seed the
+// result does not depend on how many threads ran or which chunk each took.
+class TrialRunner {
+    Rng stream; // stream of the next chunk
+
+    struct Job {
+        const Experiment *experiment;
+        long numTrials;
+        long numChunks;
+        long nextChunk;
+        vector<Rng> streams;
+        vector<long> hits;
+    };
+
+    static void *work(void *arg) {
+        Job *job = (Job *) arg;
+
+        for (;;) {
+            long c = __sync_fetch_and_add(&job->nextChunk, 1);
+            if (c >= job->numChunks) {
+                break;
+            }
+            long n = min(chunkSize, job->numTrials - c * chunkSize);
+            job->hits[c] = job->experiment->trials(job->streams[c], n);
+        }
+
+        return NULL;
+    }
+
+public:
+    static const long chunkSize = 1 << 16;
+
+    TrialRunner(const Rng &seed): stream(seed) {}
+
+    long run(const Experiment &experiment, long numTrials) {
+        if (numTrials <= 0) {
+            return 0;
+        }
+
+        Job job;
+        job.experiment = &experiment;
+        job.numTrials = numTrials;
+        job.numChunks = (numTrials + chunkSize - 1) / chunkSize;
+        job.nextChunk = 0;
+        job.hits.assign(job.numChunks, 0);
+        job.streams.reserve(job.numChunks);
+        for (long c = 0; c < job.numChunks; c++) {
+            job.streams.push_back(stream);
+            stream.jump();
+        }
+
+        if (job.numChunks > 1) {
+            workerPool().run(work, &job);
+        } else {
+            work(&job);
+        }
+
+        long total = 0;
+        for (long c = 0; c < job.numChunks; c++) {
+            total += job.hits[c];
+        }
+        return total;
+    }
+};
+
+const long TrialRunner::chunkSize;
+
+struct Estimate {
+    double probability;
+    double low, high; // confidence interval
+    long hits;
+    long numTrials;
+};
 
-    for (int i = 1; i <= numTrials; i++) {
-        string result = "";
-        for (unsigned int j = 1; j <= goal.size(); j++) {
-            result += to_string(rollDie());
+ostream &operator<<(ostream &o, const Estimate &e) {
+    return o << e.probability << " [" << e.low << ", " << e.high << "] after " << e.numTrials << " trials";
+}
+
+// Wilson score interval of hits out of numTrials, z standard deviations wide.
+void wilsonInterval(long hits, long numTrials, double z, double *low, double *high) {
+    double n = numTrials;
+    double p = hits / n;
+    double z2 = z * z;
+    double center = (p + z2 / (2 * n)) / (1 + z2 / n);
+    double halfWidth = z / (1 + z2 / n) * sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+
+    *low = max(0.0, center - halfWidth);
+    *high = min(1.0, center + halfWidth);
+}
+
+// Runs trials in batches until the Wilson interval is no wider than
+// +/- absError, or +/- relError times the estimate (0 turns either test off),
+// or maxTrials have run (none if maxTrials <= 0, and the interval is [0, 1]).
+// Each batch is sized from the current interval to reach the target, but
+// never more than doubles the trials so far; batches are whole chunks, so
+// the result still does not depend on numThreads.
+Estimate estimate(const Experiment &experiment, double relError, double absError, long maxTrials, double z = 1.96) {
+    TrialRunner runner(rng.split());
+    Estimate e;
+    long batch = TrialRunner::chunkSize;
+
+    e.hits = 0;
+    e.numTrials = 0;
+
+    // no trials, no information
+    if (maxTrials <= 0) {
+        e.probability = 0;
+        e.low = 0;
+        e.high = 1;
+        return e;
+    }
+
+    for (;;) {
+        batch = min(batch, maxTrials - e.numTrials);
+        e.hits += runner.run(experiment, batch);
+        e.numTrials += batch;
+        e.probability = (double) e.hits / e.numTrials;
+        wilsonInterval(e.hits, e.numTrials, z, &e.low, &e.high);
+
+        double halfWidth = (e.high - e.low) / 2;
+        double target = 0;
+        if (absError > 0) {
+            target = absError;
+        }
+        if (relError > 0 && e.hits > 0) {
+            target = max(target, relError * e.probability);
+        }
+
+        if (e.numTrials >= maxTrials || (target > 0 && halfWidth <= target)) {
+            return e;
+        }
+
+        // the half width shrinks like 1 / sqrt(trials)
+        double needed = target > 0 ? e.numTrials * (halfWidth / target) * (halfWidth / target) : 2.0 * e.numTrials;
+        batch = (long) min(needed - e.numTrials, (double) e.numTrials);
+        batch = max(1L, (batch + TrialRunner::chunkSize - 1) / TrialRunner::chunkSize) * TrialRunner::chunkSize;
+    }
+}
+
+// Rolling n dice and reading them as a number in base 6 is a single uniform
+// draw below 6^n.  The goal is packed that way once, in blocks of 12 dice
+// (6^12 < 2^32), so a trial is one draw and one compare per block, and stops
+// at the first block that does not match.
+class DiceExperiment : public Experiment {
+    vector<uint32_t> blocks;
+    vector<uint32_t> ranges;
+    bool possible;
+
+public:
+    static const unsigned int dicePerBlock = 12;
+
+    DiceExperiment(string goal): possible(true) {
+        for (unsigned int i = 0; i < goal.size(); i += dicePerBlock) {
+            uint32_t block = 0;
+            uint32_t range = 1;
+            for (unsigned int j = i; j < goal.size() && j < i + dicePerBlock; j++) {
+                if (goal[j] < '1' || goal[j] > '6') {
+                    possible = false;
+                }
+                block = block * 6 + (goal[j] - '1');
+                range *= 6;
+            }
+            blocks.push_back(block);
+            ranges.push_back(range);
+        }
+    }
+
+    long trials(Rng &r, long numTrials) const {
+        long hits = 0;
+
+        if (!possible) {
+            return 0;
+        }
+
+        if (blocks.size() == 1) {
+            uint32_t block = blocks[0];
+            uint32_t range = ranges[0];
+            for (long i = 1; i <= numTrials; i++) {
+                hits += r.below(range) == block;
+            }
+            return hits;
         }
-        if (result == goal) {
-            total++;
+
+        for (long i = 1; i <= numTrials; i++) {
+            unsigned int j = 0;
+            while (j < blocks.size() && r.below(ranges[j]) == blocks[j]) {
+                j++;
+            }
+            if (j == blocks.size()) {
+                hits++;
+            }
         }
+
+        return hits;
     }
+};
+
+void runSim(string goal, int numTrials, string txt) {
+    TrialRunner runner(rng.split());
+    double total = runner.run(DiceExperiment(goal), numTrials);
 
     double actualProbability = 1 / pow(6, goal.size());
     double estProbability = total / numTrials;
@@ -62,6 +387,10 @@ void runSim(string goal, int numTrials, string txt) {
     cout << "Estimated probability of " << txt << " = " << fixed << setprecision(8) << estProbability << endl;
 }
 
+Estimate estimateSim(string goal, double relError, double absError = 0, long maxTrials = 1000000000) {
+    return estimate(DiceExperiment(goal), relError, absError, maxTrials);
+}
+
 vector<int> uniformPossibleDates() {
     vector<int> possibleDates(365, 0);
 
@@ -95,32 +424,190 @@ vector<int> notUniformPossibleDates() {
     return possibleDates;
 }
 
-bool sameDate(int numPeople, int numSame) {
-    vector<int> possibleDates = uniformPossibleDates();
-    // vector<int> possibleDates = notUniformPossibleDates();
-    vector<int> birthdays(366, 0);
+// Walker's alias method, built with Vose's algorithm: after O(n) setup, each
+// draw from the weighted distribution is one random number and one lookup.
+class AliasTable {
+    vector<uint64_t> threshold; // keep the column if the low 32 bits are below this
+    vector<uint32_t> alias;
+
+public:
+    AliasTable(const vector<double> &weights): threshold(weights.size()), alias(weights.size()) {
+        uint32_t n = weights.size();
+        double sum = 0;
+
+        for (uint32_t i = 0; i < n; i++) {
+            sum += weights[i];
+        }
+
+        vector<double> scaled(n);
+        vector<uint32_t> small, large;
+        for (uint32_t i = 0; i < n; i++) {
+            scaled[i] = weights[i] * n / sum;
+            if (scaled[i] < 1) {
+                small.push_back(i);
+            } else {
+                large.push_back(i);
+            }
+        }
+
+        while (!small.empty() && !large.empty()) {
+            uint32_t s = small.back();
+            uint32_t l = large.back();
+            small.pop_back();
+            large.pop_back();
+
+            threshold[s] = (uint64_t) (scaled[s] * 4294967296.0);
+            alias[s] = l;
+            scaled[l] -= 1 - scaled[s];
+            if (scaled[l] < 1) {
+                small.push_back(l);
+            } else {
+                large.push_back(l);
+            }
+        }
 
-    for(int p = 1; p <= numPeople; p++) {
-        int index = randint(0, possibleDates.size() - 1);
-        int birthDate = possibleDates[index];
-        birthdays[birthDate]++;
+        // what is left is 1 up to rounding
+        for (unsigned int i = 0; i < large.size(); i++) {
+            threshold[large[i]] = UINT64_C(1) << 32;
+            alias[large[i]] = large[i];
+        }
+        for (unsigned int i = 0; i < small.size(); i++) {
+            threshold[small[i]] = UINT64_C(1) << 32;
+            alias[small[i]] = small[i];
+        }
     }
 
-    return *max_element(birthdays.begin(), birthdays.end()) >= numSame;
+    int size() const {
+        return alias.size();
+    }
+
+    // The column comes from the high 32 bits (Lemire's method, as in
+    // Random::below) and the coin from the independent low 32 bits.
+    int sample(Rng &r) const {
+        uint32_t n = alias.size();
+        uint64_t x = r.next();
+        uint64_t m = (x >> 32) * n;
+
+        if ((uint32_t) m < n) {
+            uint32_t t = -n % n;
+            while ((uint32_t) m < t) {
+                x = r.next();
+                m = (x >> 32) * n;
+            }
+        }
+
+        uint32_t column = m >> 32;
+        return (x & 0xffffffff) < threshold[column] ? column : alias[column];
+    }
+};
+
+// How often each day appears in a list of possible dates.
+vector<double> dayWeights(const vector<int> &possibleDates) {
+    vector<double> weights(366, 0);
+
+    for (unsigned int i = 0; i < possibleDates.size(); i++) {
+        weights[possibleDates[i]]++;
+    }
+
+    return weights;
 }
 
-double birthdayProb(int numPeople, int numSame, int numTrials) {
-    double numHits = 0;
+// The calendar used when none is given, built once.
+const AliasTable &possibleDays() {
+    static AliasTable days(dayWeights(uniformPossibleDates()));
+    // static AliasTable days(dayWeights(notUniformPossibleDates()));
+    return days;
+}
+
+// Birthday counters reused from one trial to the next.  A counter only
+// holds a value for the trial it was stamped with, so starting a new trial
+// does not need to clear them.
+class BirthdayCounter {
+    vector<uint32_t> counts;
+    vector<uint32_t> stamps;
+    uint32_t trial;
+
+public:
+    BirthdayCounter(int numDays): counts(numDays, 0), stamps(numDays, 0), trial(0) {}
+
+    void reset() {
+        if (++trial == 0) {
+            stamps.assign(stamps.size(), 0);
+            trial = 1;
+        }
+    }
+
+    uint32_t add(int day) {
+        if (stamps[day] != trial) {
+            stamps[day] = trial;
+            counts[day] = 0;
+        }
+        return ++counts[day];
+    }
+};
+
+bool sameDate(const AliasTable &days, int numPeople, int numSame, Rng &r, BirthdayCounter &birthdays) {
+    if (numSame <= 0) {
+        return true;
+    }
+
+    birthdays.reset();
+    for (int p = 1; p <= numPeople; p++) {
+        if (birthdays.add(days.sample(r)) >= (uint32_t) numSame) {
+            return true;
+        }
+    }
 
-    for (int t = 1; t <= numTrials; t++) {
-        if (sameDate(numPeople, numSame)) {
-            numHits++;
+    return false;
+}
+
+bool sameDate(int numPeople, int numSame, Rng &r) {
+    BirthdayCounter birthdays(possibleDays().size());
+    return sameDate(possibleDays(), numPeople, numSame, r, birthdays);
+}
+
+bool sameDate(int numPeople, int numSame) {
+    return sameDate(numPeople, numSame, rng);
+}
+
+class BirthdayExperiment : public Experiment {
+    AliasTable days;
+    int numPeople, numSame;
+
+public:
+    BirthdayExperiment(int numPeople, int numSame, const AliasTable &days = possibleDays()):
+        days(days), numPeople(numPeople), numSame(numSame) {}
+
+    long trials(Rng &r, long numTrials) const {
+        BirthdayCounter birthdays(days.size());
+        long hits = 0;
+
+        for (long t = 1; t <= numTrials; t++) {
+            if (sameDate(days, numPeople, numSame, r, birthdays)) {
+                hits++;
+            }
         }
+
+        return hits;
     }
+};
+
+double birthdayProb(int numPeople, int numSame, int numTrials, const AliasTable &days) {
+    TrialRunner runner(rng.split());
+    double numHits = runner.run(BirthdayExperiment(numPeople, numSame, days), numTrials);
 
     return numHits / numTrials;
 }
 
+double birthdayProb(int numPeople, int numSame, int numTrials) {
+    return birthdayProb(numPeople, numSame, numTrials, possibleDays());
+}
+
+Estimate estimateBirthdayProb(int numPeople, int numSame, double relError, double absError = 0,
+                              long maxTrials = 1000000000, const AliasTable &days = possibleDays()) {
+    return estimate(BirthdayExperiment(numPeople, numSame, days), relError, absError, maxTrials);
+}
+
 double factorial(int n) {
     double f = 1;
 
@@ -131,6 +618,134 @@ double factorial(int n) {
     return f;
 }
 
+// 1 - numDays! / (numDays^numPeople * (numDays - numPeople)!), with the
+// products (numDays)(numDays - 1)...(numDays - i + 1) and numDays^i kept
+// between calls instead of recomputing both factorials each time.
+mpf_class exactSharedBirthdayProb(int numPeople, int numDays = 366) {
+    static map<int, vector<mpz_class> > fallingProducts;
+    static map<int, vector<mpz_class> > powers;
+
+    if (numPeople > numDays) {
+        return 1;
+    }
+
+    vector<mpz_class> &falling = fallingProducts[numDays];
+    vector<mpz_class> &power = powers[numDays];
+    if (falling.empty()) {
+        falling.push_back(1);
+        power.push_back(1);
+    }
+    while ((int) falling.size() <= numPeople) {
+        int i = falling.size();
+        falling.push_back(falling[i - 1] * (numDays - i + 1));
+        power.push_back(power[i - 1] * numDays);
+    }
+
+    mpf_class numerator = falling[numPeople];
+    mpf_class denom = power[numPeople];
+    return 1 - numerator / denom;
+}
+
+// Same as above in double precision, from the log of the chance that all
+// birthdays differ, kept per number of days and extended as needed.
+double sharedBirthdayProb(int numPeople, int numDays = 366) {
+    static map<int, vector<double> > logDistinct;
+
+    if (numPeople > numDays) {
+        return 1;
+    }
+
+    vector<double> &logs = logDistinct[numDays];
+    if (logs.empty()) {
+        logs.push_back(0);
+    }
+    while ((int) logs.size() <= numPeople) {
+        int i = logs.size();
+        logs.push_back(logs[i - 1] + log1p(-(double) (i - 1) / numDays));
+    }
+
+    return 0 - expm1(logs[numPeople]);
+}
+
+// Chance that at least numSame of numPeople share a birthday, each person
+// landing on day d with probability proportional to dayWeights[d].
+//
+// Going through the days one at a time, the number of the n people left that
+// fall on day d is binomial with p = w[d] / (w[d] + ... + w[last]), and the
+// others spread over the remaining days in the same way.  So with q_d(n) the
+// chance that n people over days d..last never reach numSame on a day,
+//     q_d(n) = sum_{j < numSame} Binom(n, j, p) q_{d+1}(n - j)
+// which is O(days * numPeople * numSame).
+double sameBirthdayProb(int numPeople, int numSame, const vector<double> &dayWeights) {
+    if (numSame <= 0) {
+        return 1;
+    }
+    if (numSame == 1) {
+        return numPeople > 0 ? 1 : 0;
+    }
+
+    int last = dayWeights.size() - 1;
+    while (last >= 0 && dayWeights[last] <= 0) {
+        last--;
+    }
+    if (last < 0) {
+        return 0;
+    }
+
+    // all the people left go to the last day
+    vector<double> q(numPeople + 1), next(numPeople + 1);
+    for (int n = 0; n <= numPeople; n++) {
+        q[n] = n < numSame ? 1 : 0;
+    }
+
+    double remaining = dayWeights[last];
+    for (int d = last - 1; d >= 0; d--) {
+        if (dayWeights[d] <= 0) {
+            continue;
+        }
+        remaining += dayWeights[d];
+        double p = dayWeights[d] / remaining;
+        double odds = p / (1 - p);
+
+        q.swap(next);
+        double none = 1; // (1 - p)^n
+        for (int n = 0; n <= numPeople; n++) {
+            double binom = none;
+            double sum = 0;
+            for (int j = 0; j < numSame && j <= n; j++) {
+                sum += binom * next[n - j];
+                binom *= odds * (n - j) / (j + 1);
+            }
+            q[n] = sum;
+            none *= 1 - p;
+        }
+    }
+
+    return 1 - q[numPeople];
+}
+
+double sameBirthdayProb(int numPeople, int numSame, int numDays = 366) {
+    if (numSame == 2) {
+        return sharedBirthdayProb(numPeople, numDays);
+    }
+    return sameBirthdayProb(numPeople, numSame, vector<double>(numDays, 1));
+}
+
+// For many people: the number on each day is close to Poisson with mean
+// numPeople / numDays, and the days are close to independent.
+double poissonSameBirthdayProb(double numPeople, int numSame, int numDays = 366) {
+    double lambda = numPeople / numDays;
+    double term = exp(-lambda);
+    double below = 0; // P(Poisson(lambda) < numSame)
+
+    for (int j = 0; j < numSame; j++) {
+        below += term;
+        term *= lambda / (j + 1);
+    }
+
+    return 0 - expm1(numDays * log(below));
+}
+
 int main() {
     // srand(time(NULL));
     // srand(0);
@@ -140,6 +755,7 @@ int main() {
     // testRoll(5);
     // runSim("11111", 1000, "11111");
     // runSim("11111", 10000000, "11111");
+    // cout << "Estimated probability of 11111 = " << estimateSim("11111", 0.01) << endl;
 
     int np[] = {10, 20, 40, 100};
     int n = sizeof(np) / sizeof(int);
@@ -149,22 +765,18 @@ int main() {
 
         double estProb = birthdayProb(numPeople, 2, 10000);
         // double estProb = birthdayProb(numPeople, 3, 10000);
+        // double estProb = estimateBirthdayProb(numPeople, 2, 0, 0.001).probability;
 
         //double numerator = factorial(366);
-        mpf_class numerator = mpz_class::factorial(366);
-
         // double denom = pow(366, numPeople) * factorial(366 - numPeople);
-        mpz_t x;
-        mpz_init(x);
-        mpz_ui_pow_ui(x, 366, numPeople);
-        mpf_class denom = mpz_class(x) * mpz_class::factorial(366 - numPeople);
-
         // 1 - numerator / denom
-        mpf_class actualProb = 1 - numerator / denom;
+        mpf_class actualProb = exactSharedBirthdayProb(numPeople, 366);
+        // double actualProb = sameBirthdayProb(numPeople, 3, dayWeights(uniformPossibleDates()));
+        // double actualProb = sameBirthdayProb(numPeople, 3, dayWeights(notUniformPossibleDates()));
 
         cout << "For " << numPeople << " est. prob. of a shared birthday is " << estProb << endl;
         cout << "Actual prob. for N = 100 = " << setprecision(16) << actualProb << endl;
-
-        mpz_clear(x);
     }
+
+    return 0;
 }
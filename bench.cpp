@@ -0,0 +1,391 @@
+// Scaling benchmarks for the four programs, printed as JSON.
+//
+//     g++ -std=c++98 -O2 -pthread bench.cpp -o bench -lgmpxx -lgmp
+//     g++ -std=c++98 -O2 -pthread -DCOUNTERS bench.cpp -o bench -lgmpxx -lgmp
+//
+// Each program is included in a namespace of its own with its main renamed,
+// so what runs here is the same code the programs run.  Every size is
+// repeated until it has run for at least minSeconds; time, allocations and
+// counters are reported per run.
+
+#include <algorithm>
+#include <climits>
+#include <gmpxx.h>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "counters.h"
+#include "rng.h"
+
+// The programs below are included whole, inside a namespace.  Every header
+// they include must already be included above, at global scope: then its
+// include guard makes the copy inside the namespace empty.  A program that
+// starts using a new header needs it added to the list above, or the
+// standard library would be declared inside its namespace and fail to build.
+
+#define main knapsackMain
+namespace knapsack {
+#include "01-knapsack.cpp"
+}
+#undef main
+
+#define main fibMain
+namespace fib {
+#include "02-fib.cpp"
+}
+#undef main
+
+#define main fibGmpMain
+namespace fibGmp {
+#include "02-fib-gmp.cpp"
+}
+#undef main
+
+#define main graphsMain
+namespace graphs {
+#include "03-graphs.cpp"
+}
+#undef main
+
+#define main simMain
+namespace sim {
+#include "04-sim.cpp"
+}
+#undef main
+
+using namespace std;
+
+// Every allocation goes through here, including GMP's.
+
+static long allocations = 0;
+
+void *operator new(size_t size) throw (bad_alloc)
+{
+    __sync_fetch_and_add(&allocations, 1);
+    void *p = malloc(size > 0 ? size : 1);
+    if (p == NULL) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+// kept out of line, or GCC sees free() paired with operator new and warns
+__attribute__((noinline)) void operator delete(void *p) throw ()
+{
+    free(p);
+}
+
+void *gmpAllocate(size_t size)
+{
+    __sync_fetch_and_add(&allocations, 1);
+    return malloc(size);
+}
+
+void *gmpReallocate(void *p, size_t, size_t size)
+{
+    __sync_fetch_and_add(&allocations, 1);
+    return realloc(p, size);
+}
+
+void gmpFree(void *p, size_t)
+{
+    free(p);
+}
+
+double now()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+string to_string(long n)
+{
+    stringstream out;
+    out << n;
+    return out.str();
+}
+
+class Benchmark
+{
+public:
+    virtual ~Benchmark() {}
+
+    // Runs once and returns the units of work done (items, calls, trials...).
+    virtual double run() = 0;
+};
+
+double minSeconds = 0.2;
+bool firstResult = true;
+
+void measure(string name, long size, string unit, Benchmark &benchmark)
+{
+    long runs = 0;
+    double work = 0;
+    long allocated = allocations;
+#ifdef COUNTERS
+    counters = Counters();
+#endif
+    double start = now();
+    double elapsed;
+
+    do {
+        work += benchmark.run();
+        runs++;
+        elapsed = now() - start;
+    } while (elapsed < minSeconds);
+
+    cout << (firstResult ? "" : ",\n");
+    firstResult = false;
+
+    cout << "    {\"name\": \"" << name << "\", \"size\": " << size
+         << ", \"runs\": " << runs
+         << ", \"seconds\": " << elapsed / runs
+         << ", \"allocations\": " << (allocations - allocated) / runs
+         << ", \"throughput\": " << work / elapsed
+         << ", \"unit\": \"" << unit << "/s\"";
+#ifdef COUNTERS
+    cout << ", \"counters\": {"
+         << "\"recursiveCalls\": " << counters.recursiveCalls / runs
+         << ", \"memoHits\": " << counters.memoHits / runs
+         << ", \"memoMisses\": " << counters.memoMisses / runs
+         << ", \"queuePushes\": " << counters.queuePushes / runs
+         << ", \"rngDraws\": " << counters.rngDraws / runs
+         << "}";
+#endif
+    cout << "}" << flush;
+}
+
+// 01-knapsack
+
+vector<knapsack::Food> largeMenu(int numItems)
+{
+    vector<knapsack::Food> items;
+    knapsack::rng.seed(0);
+    knapsack::buildLargeMenu(numItems, 90, 250, &items);
+    return items;
+}
+
+class Greedy : public Benchmark
+{
+    vector<knapsack::Food> items;
+
+public:
+    Greedy(int numItems): items(largeMenu(numItems)) {}
+
+    double run()
+    {
+        vector<knapsack::Food> taken;
+        knapsack::greedy(items, 750, knapsack::sortByDensity, &taken);
+        return items.size();
+    }
+};
+
+class MaxVal : public Benchmark
+{
+    vector<knapsack::Food> items;
+
+public:
+    MaxVal(int numItems): items(largeMenu(numItems)) {}
+
+    double run()
+    {
+        vector<knapsack::Food> taken;
+        knapsack::maxVal(items, 750, &taken);
+        return items.size();
+    }
+};
+
+class FastMaxVal : public Benchmark
+{
+    vector<knapsack::Food> items;
+
+public:
+    FastMaxVal(int numItems): items(largeMenu(numItems)) {}
+
+    double run()
+    {
+        vector<knapsack::Food> taken;
+        knapsack::fastMaxVal(items, 750, &taken);
+        return items.size();
+    }
+};
+
+// 02-fib
+
+class FastFib : public Benchmark
+{
+    int n;
+
+public:
+    FastFib(int n): n(n) {}
+
+    double run()
+    {
+        fib::fastFib(n);
+        return n;
+    }
+};
+
+class FastFibGmp : public Benchmark
+{
+    int n;
+
+public:
+    FastFibGmp(int n): n(n) {}
+
+    double run()
+    {
+        fibGmp::fastFib(n);
+        return n;
+    }
+};
+
+// 03-graphs
+
+// Node i has edges to its children 2i + 1 and 2i + 2 and back to its parent,
+// so from the root there is exactly one simple path to every node, and
+// searching for the last node visits all of them.
+void buildTreeGraph(int numNodes, graphs::DiGraph *graph)
+{
+    for (int i = 0; i < numNodes; i++) {
+        graph->addNode(graphs::Node(to_string((long) i)));
+    }
+    for (int i = 1; i < numNodes; i++) {
+        graphs::Node parent = graph->nodeAt((i - 1) / 2);
+        graphs::Node child = graph->nodeAt(i);
+        graph->addEdge(graphs::Edge(parent, child));
+        graph->addEdge(graphs::Edge(child, parent));
+    }
+}
+
+class BFS : public Benchmark
+{
+    graphs::DiGraph graph;
+
+public:
+    BFS(int numNodes)
+    {
+        buildTreeGraph(numNodes, &graph);
+    }
+
+    double run()
+    {
+        graphs::BFS(graph, graph.nodeAt(0), graph.nodeAt(graph.size() - 1));
+        return graph.size();
+    }
+};
+
+class DFS : public Benchmark
+{
+    graphs::DiGraph graph;
+
+public:
+    DFS(int numNodes)
+    {
+        buildTreeGraph(numNodes, &graph);
+    }
+
+    double run()
+    {
+        graphs::DFS(graph, graph.nodeAt(0), graph.nodeAt(graph.size() - 1));
+        return graph.size();
+    }
+};
+
+// 04-sim
+
+class BirthdayProb : public Benchmark
+{
+    int numPeople;
+    int numTrials;
+
+public:
+    BirthdayProb(int numPeople, int numTrials): numPeople(numPeople), numTrials(numTrials) {}
+
+    double run()
+    {
+        sim::birthdayProb(numPeople, 2, numTrials);
+        return numTrials;
+    }
+};
+
+// runSim without the printing
+class RunSim : public Benchmark
+{
+    string goal;
+    int numTrials;
+
+public:
+    RunSim(string goal, int numTrials): goal(goal), numTrials(numTrials) {}
+
+    double run()
+    {
+        sim::TrialRunner runner(sim::rng.split());
+        runner.run(sim::DiceExperiment(goal), numTrials);
+        return numTrials;
+    }
+};
+
+int main()
+{
+    mp_set_memory_functions(gmpAllocate, gmpReallocate, gmpFree);
+    sim::rng.seed(0);
+
+    cout << "{\"benchmarks\": [\n";
+
+    for (int n = 1000; n <= 64000; n *= 4) {
+        Greedy b(n);
+        measure("greedy", n, "items", b);
+    }
+    for (int n = 8; n <= 20; n += 4) {
+        MaxVal b(n);
+        measure("maxVal", n, "items", b);
+    }
+    for (int n = 50; n <= 800; n *= 2) {
+        FastMaxVal b(n);
+        measure("fastMaxVal", n, "items", b);
+    }
+
+    for (int n = 10; n <= 40; n += 10) {
+        FastFib b(n);
+        measure("fastFib", n, "n", b);
+    }
+    for (int n = 1000; n <= 8000; n *= 2) {
+        FastFibGmp b(n);
+        measure("fastFib (gmp)", n, "n", b);
+    }
+
+    for (int n = 250; n <= 4000; n *= 2) {
+        BFS b(n);
+        measure("BFS", n, "nodes", b);
+    }
+    for (int n = 1000; n <= 1024000; n *= 4) {
+        DFS b(n);
+        measure("DFS", n, "nodes", b);
+    }
+
+    int np[] = {10, 20, 40, 100};
+    for (unsigned int i = 0; i < sizeof(np) / sizeof(int); i++) {
+        BirthdayProb b(np[i], 100000);
+        measure("birthdayProb", np[i], "trials", b);
+    }
+    for (int n = 100000; n <= 10000000; n *= 10) {
+        RunSim b("11111", n);
+        measure("runSim", n, "trials", b);
+    }
+
+    cout << "\n]}" << endl;
+}
@@ -0,0 +1,27 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+// Hot path counters, read by bench.cpp.  They are only compiled in with
+// -DCOUNTERS; otherwise COUNT() expands to nothing.
+
+#ifdef COUNTERS
+
+struct Counters {
+    long recursiveCalls;
+    long memoHits;
+    long memoMisses;
+    long queuePushes;
+    long rngDraws;
+};
+
+static Counters counters;
+
+#define COUNT(name) __sync_fetch_and_add(&counters.name, 1)
+
+#else
+
+#define COUNT(name) ((void) 0)
+
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "counters.h"
+
+// xoshiro256** 1.0, http://prng.di.unimi.it/
+// The state is seeded from a single 64 bits value through splitmix64.
+class Xoshiro256
+{
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    void jump(const uint64_t polynomial[4])
+    {
+        uint64_t t[4] = {0, 0, 0, 0};
+
+        for (int i = 0; i < 4; i++) {
+            for (int b = 0; b < 64; b++) {
+                if (polynomial[i] & (UINT64_C(1) << b)) {
+                    t[0] ^= s[0];
+                    t[1] ^= s[1];
+                    t[2] ^= s[2];
+                    t[3] ^= s[3];
+                }
+                next();
+            }
+        }
+
+        s[0] = t[0];
+        s[1] = t[1];
+        s[2] = t[2];
+        s[3] = t[3];
+    }
+
+public:
+    Xoshiro256(uint64_t seed = 0)
+    {
+        this->seed(seed);
+    }
+
+    void seed(uint64_t seed)
+    {
+        for (int i = 0; i < 4; i++) {
+            uint64_t z = (seed += UINT64_C(0x9e3779b97f4a7c15));
+            z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+            z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+            s[i] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+
+        return result;
+    }
+
+    // same as 2^128 calls to next()
+    void jump()
+    {
+        static const uint64_t polynomial[4] = {
+            UINT64_C(0x180ec6d33cfd0aba), UINT64_C(0xd5a61266f0c9392c),
+            UINT64_C(0xa9582618e03fc9aa), UINT64_C(0x39abdc4529b1661c)
+        };
+        jump(polynomial);
+    }
+
+    // same as 2^192 calls to next()
+    void longJump()
+    {
+        static const uint64_t polynomial[4] = {
+            UINT64_C(0x76e15d3efefdcbbf), UINT64_C(0xc5004e441c522fb3),
+            UINT64_C(0x77710069854ee241), UINT64_C(0x39109bb02acbe635)
+        };
+        jump(polynomial);
+    }
+};
+
+// Random numbers on top of any engine with seed(), next(), jump() and
+// longJump().  Copies are independent: to give each thread its own stream,
+// hand it the result of split().
+template <class Engine>
+class Random
+{
+    Engine engine;
+
+public:
+    Random(uint64_t seed = 0): engine(seed)
+    {
+    }
+
+    void seed(uint64_t seed)
+    {
+        engine.seed(seed);
+    }
+
+    uint64_t next()
+    {
+        COUNT(rngDraws);
+        return engine.next();
+    }
+
+    void jump()
+    {
+        engine.jump();
+    }
+
+    // Returns the current stream and moves this one 2^192 draws ahead.
+    Random split()
+    {
+        Random stream = *this;
+        engine.longJump();
+        return stream;
+    }
+
+    // Uniform in [0, range), range > 0, without modulo bias.
+    // https://arxiv.org/abs/1805.10941
+    uint32_t below(uint32_t range)
+    {
+        uint64_t m = (next() >> 32) * range;
+        uint32_t l = (uint32_t) m;
+
+        if (l < range) {
+            uint32_t t = -range % range;
+            while (l < t) {
+                m = (next() >> 32) * range;
+                l = (uint32_t) m;
+            }
+        }
+
+        return m >> 32;
+    }
+
+    int randint(int min, int max)
+    {
+        return min + (int) below((uint32_t) (max - min) + 1);
+    }
+
+    // Uniform in [0, 1).
+    double uniform()
+    {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    void fill(int *out, size_t n, int min, int max)
+    {
+        uint32_t range = (uint32_t) (max - min) + 1;
+
+        for (size_t i = 0; i < n; i++) {
+            out[i] = min + (int) below(range);
+        }
+    }
+
+    void fill(std::vector<int> &out, int min, int max)
+    {
+        if (!out.empty()) {
+            fill(&out[0], out.size(), min, max);
+        }
+    }
+};
+
+typedef Random<Xoshiro256> Rng;
+
+#endif